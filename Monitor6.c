@@ -0,0 +1,727 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/sysinfo.h>
+#include <sys/statvfs.h>
+#include <sys/signalfd.h>
+#include <sys/inotify.h>
+#include <time.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <libgen.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#define BUFFER_SIZE 256
+#define PATH_SIZE 128
+#define NAME_SIZE 32
+#define MAX_QUEUE_SIZE 4096
+#define DEFAULT_CONFIG "monitor.conf"
+
+enum { COLLECTOR_MEMORY, COLLECTOR_DISK, COLLECTOR_NETWORK, COLLECTOR_COUNT };
+
+static const char* collector_names[COLLECTOR_COUNT] = { "memory", "disk", "network" };
+
+// Instantané de configuration : jamais modifié une fois publié
+typedef struct {
+    int enabled[COLLECTOR_COUNT];
+    int interval[COLLECTOR_COUNT];   // En secondes
+    char mount_path[PATH_SIZE];
+    char interface[NAME_SIZE];
+    char sink[PATH_SIZE];            // Vide = sortie standard
+    int queue_size;
+} Config;
+
+// Compteur de lecture par thread : impair = en section de lecture, pair = au repos
+typedef struct {
+    atomic_ulong seq;
+} ReaderSlot;
+
+// Instantané courant, remplacé par échange de pointeur (style RCU)
+static _Atomic(Config*) current_config;
+
+// File à capacité modifiable : les conditions remplacent les sémaphores de
+// Monitor5 car le nombre de places libres change lors d'un rechargement
+typedef struct {
+    char (*messages)[BUFFER_SIZE];
+    int allocated;   // Taille du tableau
+    int capacity;    // Nombre maximal de messages acceptés
+    int front;
+    int rear;
+    int count;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} Queue;
+
+// Paramètres copiés hors de l'instantané : les mesures (statvfs, sysfs)
+// peuvent bloquer et ne doivent pas retarder la période de grâce
+typedef struct {
+    char mount_path[PATH_SIZE];
+    char interface[NAME_SIZE];
+} SampleParams;
+
+// Cycle de vie d'un collecteur : l'arrêt est demandé sans attendre le thread,
+// qui peut être bloqué dans une mesure ; il est récupéré une fois terminé
+enum { COLLECTOR_IDLE, COLLECTOR_RUNNING, COLLECTOR_STOPPING, COLLECTOR_EXITED };
+
+typedef struct {
+    int id;
+    int (*sample)(const SampleParams*, char*);
+    pthread_t thread;
+    atomic_int state;
+    ReaderSlot slot;
+    Queue* queue;
+} Collector;
+
+// Valeurs historiques (anciennes constantes de compilation)
+void default_config(Config* config) {
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        config->enabled[i] = 1;
+        config->interval[i] = 2;
+    }
+    strcpy(config->mount_path, "/");
+    strcpy(config->interface, "ens33");
+    config->sink[0] = '\0';
+    config->queue_size = 10;
+}
+
+// Suppression des espaces en début et fin de chaîne
+static char* trim(char* s) {
+    while (isspace((unsigned char)*s)) s++;
+    char* end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return s;
+}
+
+static int parse_int(const char* value, int min, int max, int* out) {
+    char* end;
+    errno = 0;
+    long n = strtol(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || n < min || n > max) {
+        return -1;
+    }
+    *out = (int)n;
+    return 0;
+}
+
+static int copy_string(char* dest, size_t size, const char* value) {
+    if (strlen(value) >= size) {
+        return -1;
+    }
+    strcpy(dest, value);
+    return 0;
+}
+
+// Application d'une ligne "clé = valeur" ; retourne -1 si invalide
+static int apply_setting(Config* config, const char* key, const char* value) {
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        size_t len = strlen(collector_names[i]);
+        if (strncmp(key, collector_names[i], len) != 0 || key[len] != '.') {
+            continue;
+        }
+        const char* field = key + len + 1;
+        if (strcmp(field, "enabled") == 0) {
+            return parse_int(value, 0, 1, &config->enabled[i]);
+        }
+        if (strcmp(field, "interval") == 0) {
+            return parse_int(value, 1, 3600, &config->interval[i]);
+        }
+        if (i == COLLECTOR_DISK && strcmp(field, "path") == 0) {
+            return copy_string(config->mount_path, PATH_SIZE, value);
+        }
+        if (i == COLLECTOR_NETWORK && strcmp(field, "interface") == 0) {
+            if (strchr(value, '/') != NULL || value[0] == '\0') {
+                return -1;
+            }
+            return copy_string(config->interface, NAME_SIZE, value);
+        }
+        return -1;
+    }
+    if (strcmp(key, "queue.size") == 0) {
+        return parse_int(value, 1, MAX_QUEUE_SIZE, &config->queue_size);
+    }
+    if (strcmp(key, "sink") == 0) {
+        if (strcmp(value, "stdout") == 0) {
+            config->sink[0] = '\0';
+            return 0;
+        }
+        return copy_string(config->sink, PATH_SIZE, value);
+    }
+    return -1;
+}
+
+// Lecture du fichier de configuration dans un nouvel instantané
+Config* load_config(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        perror("Erreur lors de la lecture de la configuration");
+        return NULL;
+    }
+
+    Config* config = malloc(sizeof(Config));
+    if (config == NULL) {
+        fclose(file);
+        return NULL;
+    }
+    default_config(config);
+
+    char line[BUFFER_SIZE];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        // Ligne sans fin : trop longue, sauf s'il s'agit de la dernière du fichier
+        if (strchr(line, '\n') == NULL && getc(file) != EOF) {
+            fprintf(stderr, "%s:%d: ligne trop longue\n", path, line_number);
+            free(config);
+            fclose(file);
+            return NULL;
+        }
+        char* s = trim(line);
+        if (*s == '\0' || *s == '#') {
+            continue;
+        }
+        char* equal = strchr(s, '=');
+        if (equal != NULL) {
+            *equal = '\0';
+        }
+        if (equal == NULL || apply_setting(config, trim(s), trim(equal + 1)) != 0) {
+            fprintf(stderr, "%s:%d: paramètre invalide\n", path, line_number);
+            free(config);
+            fclose(file);
+            return NULL;
+        }
+    }
+
+    fclose(file);
+    return config;
+}
+
+// Entrée en section de lecture : aucun verrou, un simple compteur atomique
+const Config* config_read_lock(ReaderSlot* slot) {
+    atomic_fetch_add(&slot->seq, 1);
+    return atomic_load(&current_config);
+}
+
+void config_read_unlock(ReaderSlot* slot) {
+    atomic_fetch_add(&slot->seq, 1);
+}
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+// Attente que tous les lecteurs aient quitté l'instantané précédent
+void synchronize_config(ReaderSlot** slots, int count) {
+    for (int i = 0; i < count; i++) {
+        unsigned long seq = atomic_load(&slots[i]->seq);
+        if (seq & 1) {
+            while (atomic_load(&slots[i]->seq) == seq) {
+                sleep_ms(1);
+            }
+        }
+    }
+}
+
+// Initialisation de la file
+int init_queue(Queue* queue, int capacity) {
+    queue->messages = malloc(capacity * sizeof(*queue->messages));
+    if (queue->messages == NULL) {
+        return -1;
+    }
+    queue->allocated = capacity;
+    queue->capacity = capacity;
+    queue->front = 0;
+    queue->rear = 0;
+    queue->count = 0;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+    pthread_cond_init(&queue->not_full, NULL);
+    return 0;
+}
+
+// Changement de capacité en conservant tous les messages en attente
+int resize_queue(Queue* queue, int capacity) {
+    pthread_mutex_lock(&queue->mutex);
+
+    int allocated = capacity > queue->count ? capacity : queue->count;
+    char (*messages)[BUFFER_SIZE] = malloc(allocated * sizeof(*messages));
+    if (messages == NULL) {
+        pthread_mutex_unlock(&queue->mutex);
+        return -1;
+    }
+    for (int i = 0; i < queue->count; i++) {
+        memcpy(messages[i], queue->messages[(queue->front + i) % queue->allocated], BUFFER_SIZE);
+    }
+    free(queue->messages);
+
+    queue->messages = messages;
+    queue->allocated = allocated;
+    queue->capacity = capacity;
+    queue->front = 0;
+    queue->rear = queue->count % allocated;
+
+    pthread_cond_broadcast(&queue->not_full);   // Réveil des producteurs si la file a grandi
+    pthread_mutex_unlock(&queue->mutex);
+    return 0;
+}
+
+// Enfilement d'un message ; abandonné (-1) si le collecteur doit s'arrêter
+int enqueue(Queue* queue, const char* message, atomic_int* state) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count >= queue->capacity) {
+        if (atomic_load(state) != COLLECTOR_RUNNING) {
+            pthread_mutex_unlock(&queue->mutex);
+            return -1;
+        }
+        pthread_cond_wait(&queue->not_full, &queue->mutex);   // Attendre l'espace disponible
+    }
+
+    strncpy(queue->messages[queue->rear], message, BUFFER_SIZE - 1);
+    queue->messages[queue->rear][BUFFER_SIZE - 1] = '\0';
+    queue->rear = (queue->rear + 1) % queue->allocated;
+    queue->count++;
+
+    pthread_cond_signal(&queue->not_empty);   // Signaler un nouvel élément
+    pthread_mutex_unlock(&queue->mutex);
+    return 0;
+}
+
+// Réveil des producteurs en attente, par exemple pour qu'ils voient un arrêt
+void wake_producers(Queue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Défilement d'un message
+void dequeue(Queue* queue, char* buffer) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count == 0) {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);   // Attendre un élément disponible
+    }
+
+    strncpy(buffer, queue->messages[queue->front], BUFFER_SIZE - 1);
+    buffer[BUFFER_SIZE - 1] = '\0';
+    queue->front = (queue->front + 1) % queue->allocated;
+    queue->count--;
+
+    pthread_cond_signal(&queue->not_full);   // Signaler un espace libre
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Fonction pour mesurer le temps d'exécution en millisecondes
+double get_execution_time(clock_t start, clock_t end) {
+    return ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+}
+
+// Mesure de la mémoire
+int sample_memory(const SampleParams* params, char* message) {
+    (void)params;
+    clock_t start = clock();
+
+    struct sysinfo memInfo;
+    sysinfo(&memInfo);
+    long totalMemory = memInfo.totalram / (1024 * 1024);
+    long freeMemory = memInfo.freeram / (1024 * 1024);
+
+    clock_t end = clock();
+    double execution_time = get_execution_time(start, end);
+
+    snprintf(message, BUFFER_SIZE, "Mémoire totale: %ld MB, Mémoire libre: %ld MB, Temps: %.2f ms",
+             totalMemory, freeMemory, execution_time);
+    return 0;
+}
+
+// Mesure du disque
+int sample_disk(const SampleParams* params, char* message) {
+    clock_t start = clock();
+
+    struct statvfs diskInfo;
+    if (statvfs(params->mount_path, &diskInfo) != 0) {
+        perror("Erreur lors de la lecture du disque");
+        return -1;
+    }
+    unsigned long long totalDisk = (diskInfo.f_blocks * diskInfo.f_frsize) / (1024 * 1024);
+    unsigned long long freeDisk = (diskInfo.f_bfree * diskInfo.f_frsize) / (1024 * 1024);
+
+    clock_t end = clock();
+    double execution_time = get_execution_time(start, end);
+
+    snprintf(message, BUFFER_SIZE, "Disque total (%s): %llu MB, Disque libre: %llu MB, Temps: %.2f ms",
+             params->mount_path, totalDisk, freeDisk, execution_time);
+    return 0;
+}
+
+// Mesure du réseau
+int sample_network(const SampleParams* params, char* message) {
+    clock_t start = clock();
+    char path[PATH_SIZE];
+
+    snprintf(path, PATH_SIZE, "/sys/class/net/%s/statistics/rx_bytes", params->interface);
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror("Erreur lors de la lecture du réseau (rx_bytes)");
+        return -1;
+    }
+    unsigned long rx_bytes = 0;
+    int read_ok = fscanf(file, "%lu", &rx_bytes) == 1;
+    fclose(file);
+    if (!read_ok) {
+        fprintf(stderr, "Erreur lors de la lecture du réseau (rx_bytes): valeur invalide\n");
+        return -1;
+    }
+
+    snprintf(path, PATH_SIZE, "/sys/class/net/%s/statistics/tx_bytes", params->interface);
+    file = fopen(path, "r");
+    if (file == NULL) {
+        perror("Erreur lors de la lecture du réseau (tx_bytes)");
+        return -1;
+    }
+    unsigned long tx_bytes = 0;
+    read_ok = fscanf(file, "%lu", &tx_bytes) == 1;
+    fclose(file);
+    if (!read_ok) {
+        fprintf(stderr, "Erreur lors de la lecture du réseau (tx_bytes): valeur invalide\n");
+        return -1;
+    }
+
+    clock_t end = clock();
+    double execution_time = get_execution_time(start, end);
+
+    snprintf(message, BUFFER_SIZE, "Données reçues (%s): %lu bytes, Données envoyées: %lu bytes, Temps: %.2f ms",
+             params->interface, rx_bytes, tx_bytes, execution_time);
+    return 0;
+}
+
+static long elapsed_ms(const struct timespec* since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since->tv_sec) * 1000 + (now.tv_nsec - since->tv_nsec) / 1000000;
+}
+
+// Lecture de l'intervalle courant du collecteur
+static int current_interval(Collector* collector) {
+    const Config* config = config_read_lock(&collector->slot);
+    int interval = config->interval[collector->id];
+    config_read_unlock(&collector->slot);
+    return interval;
+}
+
+// Producteur générique : relit l'instantané courant à chaque itération
+void* collector_thread(void* arg) {
+    Collector* collector = (Collector*)arg;
+
+    while (1) {
+        // Un arrêt peut être annulé par un rechargement avant la sortie du thread
+        int expected = COLLECTOR_STOPPING;
+        if (atomic_compare_exchange_strong(&collector->state, &expected, COLLECTOR_EXITED)) {
+            break;
+        }
+
+        char message[BUFFER_SIZE];
+        SampleParams params;
+        struct timespec last_sample;
+        clock_gettime(CLOCK_MONOTONIC, &last_sample);
+
+        const Config* config = config_read_lock(&collector->slot);
+        strcpy(params.mount_path, config->mount_path);
+        strcpy(params.interface, config->interface);
+        config_read_unlock(&collector->slot);
+
+        if (collector->sample(&params, message) == 0) {
+            enqueue(collector->queue, message, &collector->state);
+        }
+
+        // Pause découpée : arrêt rapide et prise en compte immédiate d'un
+        // nouvel intervalle, même raccourci pendant l'attente
+        while (atomic_load(&collector->state) == COLLECTOR_RUNNING
+               && elapsed_ms(&last_sample) < current_interval(collector) * 1000L) {
+            sleep_ms(100);
+        }
+    }
+    return NULL;
+}
+
+// La sortie est ouverte par le thread principal et transmise au consommateur
+typedef struct {
+    Queue* queue;
+    _Atomic(FILE*) next_out;
+} Consumer;
+
+// Consommateur : écrit les messages vers la sortie configurée
+void* consumer(void* arg) {
+    Consumer* consumer = (Consumer*)arg;
+    char message[BUFFER_SIZE];
+    FILE* out = stdout;
+
+    while (1) {
+        dequeue(consumer->queue, message);
+
+        // Bascule vers la nouvelle sortie si le thread principal en a publié une
+        FILE* next = atomic_exchange(&consumer->next_out, NULL);
+        if (next != NULL) {
+            if (out != stdout) {
+                fclose(out);
+            }
+            out = next;
+        }
+
+        fprintf(out, "%s\n", message);
+        fflush(out);
+    }
+    return NULL;
+}
+
+// Ouverture d'une sortie : fichier ordinaire uniquement, sans jamais bloquer
+// (une FIFO sans lecteur bloquerait le consommateur)
+FILE* open_sink(const char* sink) {
+    if (sink[0] == '\0') {
+        return stdout;
+    }
+
+    int fd = open(sink, O_WRONLY | O_APPEND | O_CREAT | O_NONBLOCK | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        perror("Erreur lors de l'ouverture de la sortie");
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        fprintf(stderr, "Erreur lors de l'ouverture de la sortie: %s n'est pas un fichier ordinaire\n", sink);
+        close(fd);
+        return NULL;
+    }
+    FILE* file = fdopen(fd, "a");
+    if (file == NULL) {
+        perror("Erreur lors de l'ouverture de la sortie");
+        close(fd);
+    }
+    return file;
+}
+
+static Collector collectors[COLLECTOR_COUNT];
+static Consumer consumer_state;
+
+// Transmission d'une sortie au consommateur ; une sortie publiée mais pas
+// encore prise en compte est refermée
+void publish_sink(FILE* out) {
+    FILE* stale = atomic_exchange(&consumer_state.next_out, out);
+    if (stale != NULL && stale != stdout) {
+        fclose(stale);
+    }
+}
+
+// Récupération des collecteurs arrêtés : le thread a déjà quitté sa boucle,
+// pthread_join ne bloque donc pas
+void reap_collectors(void) {
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        Collector* collector = &collectors[i];
+        if (atomic_load(&collector->state) == COLLECTOR_EXITED) {
+            pthread_join(collector->thread, NULL);
+            atomic_store(&collector->state, COLLECTOR_IDLE);
+            fprintf(stderr, "Collecteur arrêté: %s\n", collector_names[i]);
+        }
+    }
+}
+
+// Démarrage et arrêt des seuls collecteurs dont l'activation a changé,
+// sans jamais attendre la fin d'un thread
+void apply_collectors(const Config* config) {
+    reap_collectors();
+
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        Collector* collector = &collectors[i];
+        if (config->enabled[i]) {
+            // Un collecteur en cours d'arrêt est simplement relancé
+            int expected = COLLECTOR_STOPPING;
+            if (atomic_compare_exchange_strong(&collector->state, &expected, COLLECTOR_RUNNING)) {
+                continue;
+            }
+            if (expected == COLLECTOR_EXITED) {
+                reap_collectors();
+            }
+            if (atomic_load(&collector->state) != COLLECTOR_IDLE) {
+                continue;
+            }
+            atomic_store(&collector->state, COLLECTOR_RUNNING);
+            if (pthread_create(&collector->thread, NULL, collector_thread, collector) == 0) {
+                fprintf(stderr, "Collecteur démarré: %s\n", collector_names[i]);
+            } else {
+                atomic_store(&collector->state, COLLECTOR_IDLE);
+                fprintf(stderr, "Erreur lors du démarrage du collecteur %s\n", collector_names[i]);
+            }
+        } else {
+            int expected = COLLECTOR_RUNNING;
+            if (atomic_compare_exchange_strong(&collector->state, &expected, COLLECTOR_STOPPING)) {
+                wake_producers(collector->queue);
+            }
+        }
+    }
+}
+
+// Construction et publication d'un nouvel instantané
+void reload_config(const char* path, Queue* queue) {
+    Config* config = load_config(path);
+    if (config == NULL) {
+        fprintf(stderr, "Configuration inchangée\n");
+        return;
+    }
+
+    // La nouvelle sortie est ouverte avant publication : un échec rejette l'instantané
+    Config* old = atomic_load(&current_config);
+    FILE* out = NULL;
+    if (strcmp(config->sink, old->sink) != 0) {
+        out = open_sink(config->sink);
+        if (out == NULL) {
+            fprintf(stderr, "Configuration inchangée\n");
+            free(config);
+            return;
+        }
+    }
+
+    if (config->queue_size != old->queue_size && resize_queue(queue, config->queue_size) != 0) {
+        fprintf(stderr, "Erreur lors du redimensionnement de la file, configuration inchangée\n");
+        if (out != NULL && out != stdout) {
+            fclose(out);
+        }
+        free(config);
+        return;
+    }
+
+    atomic_store(&current_config, config);
+    if (out != NULL) {
+        publish_sink(out);
+    }
+    apply_collectors(config);
+
+    // Libération de l'ancien instantané après la période de grâce
+    ReaderSlot* slots[COLLECTOR_COUNT];
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        slots[i] = &collectors[i].slot;
+    }
+    synchronize_config(slots, COLLECTOR_COUNT);
+    free(old);
+
+    fprintf(stderr, "Configuration rechargée\n");
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : DEFAULT_CONFIG;
+
+    // Configuration initiale : valeurs par défaut si le fichier est absent
+    Config* config;
+    if (access(path, F_OK) == 0) {
+        config = load_config(path);
+    } else {
+        config = malloc(sizeof(Config));
+        if (config != NULL) {
+            default_config(config);
+            fprintf(stderr, "%s introuvable, valeurs par défaut utilisées\n", path);
+        }
+    }
+    if (config == NULL) {
+        return 1;
+    }
+    atomic_store(&current_config, config);
+
+    Queue queue;
+    if (init_queue(&queue, config->queue_size) != 0) {
+        perror("Erreur lors de l'allocation de la file");
+        return 1;
+    }
+
+    // SIGHUP est bloqué dans tous les threads et lu via signalfd
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    int signal_fd = signalfd(-1, &mask, 0);
+    if (signal_fd < 0) {
+        perror("Erreur lors de la création de signalfd");
+        return 1;
+    }
+
+    // Surveillance du répertoire : les éditeurs remplacent souvent le fichier
+    char* dir_copy = strdup(path);
+    char* base_copy = strdup(path);
+    const char* dir = dirname(dir_copy);
+    const char* base = basename(base_copy);
+    int inotify_fd = inotify_init1(0);
+    if (inotify_fd < 0 || inotify_add_watch(inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        perror("Erreur lors de la surveillance de la configuration (inotify)");
+    }
+
+    FILE* out = open_sink(config->sink);
+    if (out == NULL) {
+        return 1;
+    }
+
+    // Création des threads consommateur et producteurs
+    consumer_state.queue = &queue;
+    publish_sink(out);
+    pthread_t consumer_thread;
+    pthread_create(&consumer_thread, NULL, consumer, (void*)&consumer_state);
+
+    int (*samplers[COLLECTOR_COUNT])(const SampleParams*, char*) = { sample_memory, sample_disk, sample_network };
+    for (int i = 0; i < COLLECTOR_COUNT; i++) {
+        collectors[i].id = i;
+        collectors[i].sample = samplers[i];
+        collectors[i].queue = &queue;
+    }
+    apply_collectors(config);
+
+    // Boucle principale : rechargement sur SIGHUP ou modification du fichier
+    struct pollfd fds[2] = {
+        { .fd = signal_fd, .events = POLLIN },
+        { .fd = inotify_fd, .events = POLLIN },
+    };
+    while (1) {
+        // Réveil périodique pour récupérer les collecteurs arrêtés
+        if (poll(fds, 2, 1000) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Erreur lors de l'attente des événements");
+            break;
+        }
+        reap_collectors();
+
+        int reload = 0;
+        if (fds[0].revents & POLLIN) {
+            struct signalfd_siginfo info;
+            if (read(signal_fd, &info, sizeof(info)) == sizeof(info)) {
+                reload = 1;
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+            ssize_t len = read(inotify_fd, events, sizeof(events));
+            for (char* p = events; len > 0 && p < events + len; ) {
+                struct inotify_event* event = (struct inotify_event*)p;
+                if (event->len > 0 && strcmp(event->name, base) == 0) {
+                    reload = 1;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+
+        if (reload) {
+            reload_config(path, &queue);
+        }
+    }
+
+    close(signal_fd);
+    close(inotify_fd);
+    free(dir_copy);
+    free(base_copy);
+
+    return 0;
+}